@@ -10,8 +10,21 @@ wxIMPLEMENT_APP(App);
 
 // Initialize the application
 bool App::OnInit() {
+    // Pick the code page for incoming text: --codepage=utf8|cp437|latin1
+    MessageDecoder::CodePage codePage = MessageDecoder::CodePage::UTF8;
+    for (int i = 1; i < argc; i++)
+    {
+        wxString value;
+        if (wxString(argv[i]).StartsWith("--codepage=", &value)
+            && !MessageDecoder::ParseCodePage(value, codePage))
+        {
+            wxMessageBox("Unknown code page '" + value + "', using UTF-8.", "LED Display Board",
+                wxOK | wxICON_WARNING);
+        }
+    }
+
     // Create the main application window
-    MainFrame* frame = new MainFrame();
+    MainFrame* frame = new MainFrame(codePage);
     
     // Display the window and make it visible
     frame->Show(true);
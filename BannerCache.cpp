@@ -0,0 +1,260 @@
+// BannerCache.cpp
+// Implementation of the memory-mapped warm-start cache
+
+#include "BannerCache.h"
+#include "PortMap.h"
+#include <wx/stdpaths.h>
+#include <wx/filename.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <windows.h>
+
+namespace
+{
+    // File identification
+    const uint32_t CACHE_MAGIC = 0x4344454C;   // "LEDC"
+    const uint32_t CACHE_VERSION = 1;
+
+    // Upper bounds used to reject corrupt headers before touching the payload
+    const uint32_t MAX_TEXT_BYTES = 1024;
+    const uint32_t MAX_STRIP_WIDTH = 16384;
+    const uint32_t MAX_STRIP_HEIGHT = 512;
+
+    // The file grows in steps of this size so most messages fit without a remap
+    const size_t CACHE_GROWTH = 64 * 1024;
+
+    /**
+     * @brief On-disk header, followed by the text bytes and the coverage mask
+     *
+     * scrollPosX is excluded from the checksum so it can be rewritten in place.
+     */
+    struct CacheHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t headerSize;
+        uint32_t textBytes;
+        int32_t speed;
+        int32_t scrollPosX;
+        uint32_t stripWidth;
+        uint32_t stripHeight;
+        uint32_t checksum;
+    };
+
+    // FNV-1a over a byte range, continuing from 'hash'
+    uint32_t Fnv1a(const unsigned char* data, size_t size, uint32_t hash = 2166136261u)
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= data[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    // Checksum of the header (minus mutable fields) and the payload
+    uint32_t Checksum(const CacheHeader& header, const unsigned char* payload, size_t payloadSize)
+    {
+        CacheHeader stable = header;
+        stable.scrollPosX = 0;
+        stable.checksum = 0;
+        uint32_t hash = Fnv1a(reinterpret_cast<const unsigned char*>(&stable), sizeof(stable));
+        return Fnv1a(payload, payloadSize, hash);
+    }
+}
+
+// Constructor
+BannerCache::BannerCache(const wxString& cachePath)
+    : path(cachePath),
+    file(INVALID_HANDLE_VALUE),
+    mapping(NULL),
+    view(nullptr),
+    viewSize(0)
+{
+}
+
+// Destructor
+// Releases the mapping; dirty pages are written back by the OS
+BannerCache::~BannerCache()
+{
+    Unmap();
+}
+
+// Map
+// Opens (or creates) the cache file and maps 'size' bytes of it, growing the
+// file if needed; 0 maps the file at its current size
+bool BannerCache::Map(size_t size)
+{
+    Unmap();
+
+    file = CreateFileW(path.wc_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL,
+        OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart > MAXDWORD)
+    {
+        Unmap();
+        return false;
+    }
+    // Never shrink the file; spare capacity saves a remap later
+    if (static_cast<ULONGLONG>(fileSize.QuadPart) > size)
+    {
+        size = static_cast<size_t>(fileSize.QuadPart);
+    }
+    if (size < sizeof(CacheHeader) || size > MAXDWORD)
+    {
+        Unmap();
+        return false;
+    }
+
+    mapping = CreateFileMappingW(file, NULL, PAGE_READWRITE, 0, static_cast<DWORD>(size), NULL);
+    if (mapping == NULL)
+    {
+        Unmap();
+        return false;
+    }
+
+    view = static_cast<unsigned char*>(MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size));
+    if (view == nullptr)
+    {
+        Unmap();
+        return false;
+    }
+
+    viewSize = size;
+    return true;
+}
+
+// Unmap
+// Releases the view, the mapping and the file handle
+void BannerCache::Unmap()
+{
+    if (view)
+    {
+        UnmapViewOfFile(view);
+        view = nullptr;
+    }
+    if (mapping)
+    {
+        CloseHandle(mapping);
+        mapping = NULL;
+    }
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(file);
+        file = INVALID_HANDLE_VALUE;
+    }
+    viewSize = 0;
+}
+
+// Load
+// Maps the existing cache and validates it before copying the state out.
+// The mapping stays open for later Store() and UpdateScrollPosition() calls.
+bool BannerCache::Load(BannerCacheState& state)
+{
+    if (!wxFileName::FileExists(path) || !Map(0))
+        return false;
+
+    CacheHeader header;
+    std::memcpy(&header, view, sizeof(header));
+
+    // Validate identification and sizes before reading the payload; the file
+    // may be larger than the payload since it only ever grows
+    uint64_t maskBytes = static_cast<uint64_t>(header.stripWidth) * header.stripHeight;
+    bool valid = header.magic == CACHE_MAGIC
+        && header.version == CACHE_VERSION
+        && header.headerSize == sizeof(CacheHeader)
+        && header.textBytes <= MAX_TEXT_BYTES
+        && header.stripWidth <= MAX_STRIP_WIDTH
+        && header.stripHeight <= MAX_STRIP_HEIGHT
+        && header.speed >= PortMap::Speed::minimum() && header.speed <= PortMap::Speed::maximum()
+        && sizeof(CacheHeader) + header.textBytes + maskBytes <= viewSize;
+    if (!valid)
+        return false;
+
+    const unsigned char* payload = view + sizeof(CacheHeader);
+    size_t payloadSize = static_cast<size_t>(header.textBytes + maskBytes);
+    if (Checksum(header, payload, payloadSize) != header.checksum)
+        return false;
+
+    state.text.assign(reinterpret_cast<const char*>(payload), header.textBytes);
+    state.speed = header.speed;
+    state.scrollPosX = header.scrollPosX;
+    state.stripWidth = static_cast<int>(header.stripWidth);
+    state.stripHeight = static_cast<int>(header.stripHeight);
+    state.coverage.assign(payload + header.textBytes, payload + payloadSize);
+    return true;
+}
+
+// Store
+// Rewrites the payload in place; the mapping is only replaced when it has to grow
+bool BannerCache::Store(const BannerCacheState& state)
+{
+    size_t maskBytes = static_cast<size_t>(state.stripWidth) * state.stripHeight;
+    if (state.text.size() > MAX_TEXT_BYTES
+        || state.stripWidth < 0 || state.stripWidth > (int)MAX_STRIP_WIDTH
+        || state.stripHeight < 0 || state.stripHeight > (int)MAX_STRIP_HEIGHT
+        || state.coverage.size() < maskBytes)
+    {
+        return false;
+    }
+
+    size_t needed = sizeof(CacheHeader) + state.text.size() + maskBytes;
+    if (needed > viewSize)
+    {
+        size_t capacity = (needed + CACHE_GROWTH - 1) / CACHE_GROWTH * CACHE_GROWTH;
+        if (!Map(capacity))
+            return false;
+    }
+
+    // Invalidate the header while the payload is rewritten, so a crash in
+    // between leaves a cache that fails validation instead of a mixed one
+    const uint32_t noMagic = 0;
+    std::memcpy(view + offsetof(CacheHeader, magic), &noMagic, sizeof(noMagic));
+
+    unsigned char* payload = view + sizeof(CacheHeader);
+    std::memcpy(payload, state.text.data(), state.text.size());
+    if (maskBytes > 0)
+        std::memcpy(payload + state.text.size(), state.coverage.data(), maskBytes);
+
+    // Header (with checksum) last
+    CacheHeader header;
+    header.magic = CACHE_MAGIC;
+    header.version = CACHE_VERSION;
+    header.headerSize = sizeof(CacheHeader);
+    header.textBytes = static_cast<uint32_t>(state.text.size());
+    header.speed = state.speed;
+    header.scrollPosX = state.scrollPosX;
+    header.stripWidth = static_cast<uint32_t>(state.stripWidth);
+    header.stripHeight = static_cast<uint32_t>(state.stripHeight);
+    header.checksum = 0;
+    header.checksum = Checksum(header, payload, state.text.size() + maskBytes);
+    std::memcpy(view, &header, sizeof(header));
+    return true;
+}
+
+// UpdateScrollPosition
+// Plain store into the mapped header; the OS writes the page back lazily
+void BannerCache::UpdateScrollPosition(int posX)
+{
+    if (!view)
+        return;
+
+    int32_t value = posX;
+    std::memcpy(view + offsetof(CacheHeader, scrollPosX), &value, sizeof(value));
+}
+
+// DefaultPath
+// Cache file inside the per-user application data directory
+wxString BannerCache::DefaultPath()
+{
+    wxString dir = wxStandardPaths::Get().GetUserDataDir();
+    if (!wxFileName::DirExists(dir))
+    {
+        wxFileName::Mkdir(dir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+    }
+    return wxFileName(dir, "banner.cache").GetFullPath();
+}
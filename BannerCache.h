@@ -0,0 +1,85 @@
+// BannerCache.h
+// Memory-mapped warm-start cache for the LED display banner
+
+#pragma once
+
+#include <wx/string.h>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Snapshot of the banner that survives a restart
+ *
+ * The rendered strip is stored as an 8-bit coverage mask (0 = background,
+ * 255 = full LED colour) rather than RGB pixels, which keeps the file small.
+ * A state without a strip holds only the text and speed; the strip is
+ * rendered again on a warm start.
+ */
+struct BannerCacheState
+{
+    std::string text;                    // Last committed message (UTF-8)
+    int speed = 0;                       // Scroll speed (0-20)
+    int scrollPosX = 0;                  // Current X position of the strip
+    int stripWidth = 0;                  // Width of the rendered strip (0 = not saved)
+    int stripHeight = 0;                 // Height of the rendered strip in pixels
+    std::vector<unsigned char> coverage; // stripWidth * stripHeight mask
+};
+
+/**
+ * @brief Versioned cache file holding the last banner state
+ *
+ * The file stays mapped while the banner is alive:
+ * - Store() rewrites the payload in place, header and checksum last; the
+ *   file is only grown (and remapped) when a larger strip no longer fits
+ * - UpdateScrollPosition() patches the header in place on every frame
+ * - Load() validates magic, version, sizes and checksum before trusting it
+ *
+ * Any invalid or truncated file is treated as a cold start.
+ */
+class BannerCache
+{
+public:
+    explicit BannerCache(const wxString& cachePath);
+    ~BannerCache();
+
+    BannerCache(const BannerCache&) = delete;
+    BannerCache& operator=(const BannerCache&) = delete;
+
+    /**
+     * @brief Maps and validates the cache file
+     * @param state Receives the cached banner state
+     * @return true if a valid cache was found
+     */
+    bool Load(BannerCacheState& state);
+
+    /**
+     * @brief Writes a new banner state into the mapped file
+     * @param state State to persist
+     * @return true if the cache was written
+     */
+    bool Store(const BannerCacheState& state);
+
+    /**
+     * @brief Records the scroll position in the mapped header
+     * @param posX Current X position of the strip
+     */
+    void UpdateScrollPosition(int posX);
+
+    /**
+     * @brief Default cache location in the user's data directory
+     * @return Full path of the cache file
+     */
+    static wxString DefaultPath();
+
+private:
+    bool Map(size_t size);   // Opens and maps the file (0 = its current size)
+    void Unmap();            // Releases the mapping and handles
+
+    // Win32 handles are kept as void* so <windows.h> stays out of this header
+    wxString path;           // Cache file location
+    void* file;              // Cache file handle
+    void* mapping;           // File mapping handle
+    unsigned char* view;     // Mapped view of the whole file
+    size_t viewSize;         // Size of the mapped view
+};
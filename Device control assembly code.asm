@@ -24,6 +24,17 @@
 ; 4. Accept commands (update/exit)
 
 
+; PORT CONSTANTS (keep in sync with PortMap.h)
+SPEED_PORT      EQU 10         ; Speed control
+STATUS_PORT     EQU 20         ; Display status
+TEXT_PORT_START EQU 150        ; First character position
+TEXT_PORT_END   EQU 252        ; One past the last character position
+
+STATUS_DONE     EQU 0          ; Done writing
+STATUS_WRITING  EQU 1          ; Writing
+STATUS_EXIT     EQU 99         ; Terminate
+
+
 .MODEL SMALL
 .STACK 100H
 .DATA
@@ -59,8 +70,8 @@ MAIN PROC
     
 ; INITIALIZATION
     ; Set LED display status to "writing" mode via port 20
-    MOV AL, 1                  ; AL = 1 (writing mode)
-    MOV DX, 20                 ; DX = port 20 (status port)
+    MOV AL, STATUS_WRITING     ; AL = 1 (writing mode)
+    MOV DX, STATUS_PORT        ; DX = port 20 (status port)
     OUT DX, AL                 ; Send status to port
     
     ; Initialize data segment registers
@@ -175,7 +186,7 @@ INVALID_INPUT_NUMBER:
 VALID_INPUT:
     ; Send speed to LED controller
     MOV AL, INPUT_NUMBER      ; Get validated speed
-    MOV DX, 10                ; Port 10 = speed control
+    MOV DX, SPEED_PORT        ; Port 10 = speed control
     OUT DX, AL                ; Set speed
 
 ; TEXT DISPLAY PROCESSING
@@ -194,7 +205,7 @@ PRINT_LOOP:
     ; Initialize string processing
     LEA SI, INPUT_STRING+2    ; SI points to first character (skip length bytes)
     MOV CL, INPUT_STRING+1    ; CL = string length
-    MOV DX, 150               ; Start at port 150
+    MOV DX, TEXT_PORT_START   ; Start at port 150
 
 ; CHARACTER OUTPUT LOOP
 PRINT_CHAR:
@@ -207,9 +218,9 @@ PRINT_CHAR:
 
     ; Handle port wraparound (150-251)
     INC DX                    ; Next display position
-    CMP DX, 252               ; Past last position?
+    CMP DX, TEXT_PORT_END     ; Past last position?
     JL CONTINUE_PRINT         ; If no, continue
-    MOV DX, 150               ; If yes, wrap to start
+    MOV DX, TEXT_PORT_START   ; If yes, wrap to start
 
 CONTINUE_PRINT:
     INC SI                    ; Next character
@@ -223,8 +234,8 @@ PRINT_END_MARKER:
     OUT DX, AL                ; Send to next port
 
     ; Update display status to "done"
-    MOV AL, 0                 ; Status = done writing
-    MOV DX, 20                ; Status port
+    MOV AL, STATUS_DONE       ; Status = done writing
+    MOV DX, STATUS_PORT       ; Status port
     OUT DX, AL
 
     ; Print newline
@@ -304,8 +315,8 @@ EXIT_PROGRAM:
 ; PROGRAM TERMINATION
 EXIT:
     ; Signal termination to LED controller
-    MOV AL, 99                ; Termination status
-    MOV DX, 20                ; Status port
+    MOV AL, STATUS_EXIT       ; Termination status
+    MOV DX, STATUS_PORT       ; Status port
     OUT DX, AL                ; Send status
 
     ; Terminate program
@@ -1,9 +1,23 @@
 //Include necessary header files
 #include "MainFrame.h"
-#include "io.h"
 #include "wx/taskbar.h"
 #include <wx/timer.h>
 #include <wx/msgdlg.h>
+#include <cstring>
+
+namespace
+{
+    // Timer identifiers, all timers post to this frame
+    const int ID_IO_TIMER = wxID_HIGHEST + 1;
+    const int ID_STATUS_TIMER = wxID_HIGHEST + 2;
+    const int ID_CACHE_TIMER = wxID_HIGHEST + 3;
+
+    // Messages can arrive on every 100ms poll. The status bar shows only the
+    // latest one at most every 250ms, and the warm-start cache is saved at
+    // most once a second, so both merge bursts of messages.
+    const int STATUS_UPDATE_INTERVAL_MS = 250;
+    const int CACHE_SAVE_INTERVAL_MS = 1000;
+}
 
 // Register event handlers for the MainFrame
 wxBEGIN_EVENT_TABLE(MainFrame, wxFrame)
@@ -11,14 +25,18 @@ EVT_CLOSE(MainFrame::OnClose)  // Handle window close event
 wxEND_EVENT_TABLE()
 
 // MainFrame constructor - initializes the main window of the application
-MainFrame::MainFrame()
+MainFrame::MainFrame(MessageDecoder::CodePage codePage)
     : wxFrame(NULL, wxID_ANY, "LED Display Board", wxDefaultPosition, wxSize(1200, 270),
         (wxDEFAULT_FRAME_STYLE & ~(wxRESIZE_BORDER | wxMAXIMIZE_BOX)) | wxSTAY_ON_TOP),  // Create a fixed-size window that stays on top
-    m_dataReady(false),        // Initialize data ready flag
-    m_threadShutdown(false),   // Initialize thread shutdown flag
+    ioTimer(nullptr),          // Initialize I/O timer pointer
+    statusTimer(nullptr),      // Initialize status bar timer pointer
+    cacheTimer(nullptr),       // Initialize cache save timer pointer
     m_mutex(),                 // Initialize mutex for thread synchronization
     m_condition(m_mutex),      // Initialize condition variable for thread synchronization
-    ioTimer(nullptr)          // Initialize I/O timer pointer
+    m_threadShutdown(false),   // Initialize thread shutdown flag
+    m_dataReady(false),        // Initialize data ready flag
+    m_decoder(codePage),       // Decode messages in the requested code page
+    m_cacheWarned(false)       // No cache save has failed yet
 {
     //set Icon for the program
     wxIcon appIcon; (wxT("IDI_ICON1"), wxBITMAP_TYPE_ICO_RESOURCE);
@@ -38,15 +56,22 @@ void MainFrame::InitializeUI()
 {
     SetBackgroundColour(*wxWHITE);  // Set white background
 
-    // Initialize scrolling banner with default message
+    // Size the banner first so the restored position is clamped to its real width
     banner = new ScrollingBanner(this);
-    banner->UpdateBanner("Waiting for i/o input...", 1);
     banner->SetMinSize(wxSize(1200, 150));
     banner->SetMaxSize(wxSize(1200, 150));
+    banner->SetSize(wxSize(1200, 150));
+
+    // Resume the last committed message, or fall back to the default one
+    bool restored = banner->RestoreState();
+    if (!restored)
+    {
+        banner->UpdateBanner("Waiting for i/o input...", 1);
+    }
 
     // Create and format the port information text
     wxString portInfo = wxString::Format("Ports Being Used: Status: %ld, Speed: %ld, Text: %ld to %ld",
-        STATUS_PORT, SPEED_PORT, DATA_PORT_START, DATA_PORT_START + 101);
+        PortMap::Status::first(), PortMap::Speed::first(), PortMap::Text::first(), PortMap::Text::end() - 1);
 
     // Create and style the static text display
     staticText = new wxStaticText(this, wxID_ANY, portInfo,
@@ -63,17 +88,31 @@ void MainFrame::InitializeUI()
 
     SetSizer(sizer);
     CreateStatusBar();  // Create status bar at bottom of window
-    SetStatusText("Waiting for i/o input...");
+    if (restored)
+    {
+        SetStatusText(wxString::Format("Text: %s | Speed: %d",
+            banner->GetBannerText(), banner->GetSpeedFactor()));
+    }
+    else
+    {
+        SetStatusText("Waiting for i/o input...");
+    }
 }
 
 // Initialize I/O communication and timer
 void MainFrame::InitializeIO()
 {
     try {
-        WRITE_IO_BYTE(STATUS_PORT, 1);  // Set initial status
-        ioTimer = new wxTimer(this);    // Create timer for I/O polling
-        Bind(wxEVT_TIMER, &MainFrame::OnIOTimer, this);  // Bind timer to handler
+        PortMap::Write<PortMap::Status>(ioPorts, PortMap::STATUS_WRITING);  // Set initial status
+        ioTimer = new wxTimer(this, ID_IO_TIMER);    // Create timer for I/O polling
+        Bind(wxEVT_TIMER, &MainFrame::OnIOTimer, this, ID_IO_TIMER);  // Bind timer to handler
         ioTimer->Start(100);  // Start timer with 100ms interval
+
+        // Started when new data arrives
+        statusTimer = new wxTimer(this, ID_STATUS_TIMER);
+        Bind(wxEVT_TIMER, &MainFrame::OnStatusTimer, this, ID_STATUS_TIMER);
+        cacheTimer = new wxTimer(this, ID_CACHE_TIMER);
+        Bind(wxEVT_TIMER, &MainFrame::OnCacheTimer, this, ID_CACHE_TIMER);
     }
     catch (const std::exception& e) {
         wxMessageBox(e.what(), "I/O Error", wxOK | wxICON_ERROR);
@@ -94,18 +133,21 @@ void MainFrame::OnIOTimer(wxTimerEvent& event)
             return;
         }
 
-        statusByte = READ_IO_BYTE(STATUS_PORT);  // Read current status
+        // Read status, speed and text in a single file access
+        PortMap::ControllerSnapshot ports;
+        ports.Load(ioPorts);
+        statusByte = ports.Get<PortMap::Status>();  // Read current status
 
         // Handle different status codes
-        if (statusByte == EXIT_STATUS)  // Exit command received
+        if (statusByte == PortMap::STATUS_EXIT)  // Exit command received
         {
             Close(true);
             return;
         }
-        else if (statusByte == 0)  // New data available
+        else if (statusByte == PortMap::STATUS_DONE)  // New data available
         {
-            ReadData();  // Read the new data
-            WRITE_IO_BYTE(STATUS_PORT, 2);  // Set status to processing
+            ReadData(ports);  // Read the new data
+            PortMap::Write<PortMap::Status>(ioPorts, PortMap::STATUS_ACKNOWLEDGED);  // Set status to processing
         }
     }
     catch (const std::exception& e) {
@@ -114,25 +156,22 @@ void MainFrame::OnIOTimer(wxTimerEvent& event)
     }
 }
 
-// Read data from I/O ports
-void MainFrame::ReadData()
+// Read data from a snapshot of the I/O ports
+void MainFrame::ReadData(const PortMap::ControllerSnapshot& ports)
 {
     try {
-        std::string bannerText;
-        // Read text data until terminator is found
-        for (long currentPort = DATA_PORT_START; ; currentPort++)
-        {
-            unsigned char byte = READ_IO_BYTE(currentPort);
-            if (byte == DATA_TERMINATOR)  // Stop at terminator byte
-                break;
-            bannerText += static_cast<char>(byte);
-        }
+        // Text runs up to the terminator byte, never past the text ports
+        const unsigned char* text = ports.Data<PortMap::Text>();
+        const void* terminator = std::memchr(text, PortMap::DATA_TERMINATOR, PortMap::Text::width());
+        size_t length = terminator
+            ? static_cast<const unsigned char*>(terminator) - text
+            : PortMap::Text::width();
 
-        int speed = READ_IO_BYTE(SPEED_PORT);  // Read scroll speed
+        int speed = ports.Get<PortMap::Speed>();  // Read scroll speed
 
-        // Update member variables with thread safety
+        // Update member variables with thread safety; assign() reuses the buffer
         wxMutexLocker lock(m_mutex);
-        m_bannerText = bannerText;
+        m_bannerText.assign(reinterpret_cast<const char*>(text), length);
         m_speed = speed;
         m_dataReady = true;
 
@@ -147,13 +186,51 @@ void MainFrame::ReadData()
 // Process and display new data
 void MainFrame::HandleNewData(const std::string& text, int speed)
 {
-    banner->UpdateBanner(wxString::FromUTF8(text), speed);  // Update banner display
+    // Decode the bytes once, in a single pass, into the reused buffer
+    m_decoder.Begin();
+    m_decoder.Feed(reinterpret_cast<const unsigned char*>(text.data()), text.size());
+    banner->UpdateBanner(m_decoder.Finish(), speed);  // Update banner display
+
+    // Text and speed reach the cache at once, so a crash right after this
+    // message still restores it
+    banner->SaveMessage();
+
+    // Status bar and cached strip are throttled; messages arriving in between
+    // are merged into one update. The layout is fixed, so no Layout() is needed.
+    if (!statusTimer->IsRunning())
+    {
+        statusTimer->StartOnce(STATUS_UPDATE_INTERVAL_MS);
+    }
+    if (!cacheTimer->IsRunning())
+    {
+        cacheTimer->StartOnce(CACHE_SAVE_INTERVAL_MS);
+    }
+}
+
+// Show the latest message in the status bar
+void MainFrame::OnStatusTimer(wxTimerEvent& event)
+{
+    // Rebuild the status text in place
+    wxChar speedText[16];
+    wxSnprintf(speedText, WXSIZEOF(speedText), wxT("%d"), m_speed);
 
-    // Update status bar with new text and speed
-    wxString statusText = wxString::Format("Text: %s | Speed: %d",
-        wxString::FromUTF8(text), speed);
-    SetStatusText(statusText);
-    Layout();
+    m_statusText.clear();
+    m_statusText += wxT("Text: ");
+    m_statusText += m_decoder.GetText();
+    m_statusText += wxT(" | Speed: ");
+    m_statusText += speedText;
+    SetStatusText(m_statusText);
+}
+
+// Save the latest message for a warm start after a restart
+void MainFrame::OnCacheTimer(wxTimerEvent& event)
+{
+    // Report the first failure only; saves are retried with every message
+    if (!banner->SaveState() && !m_cacheWarned)
+    {
+        m_cacheWarned = true;
+        wxLogWarning("The banner cache could not be saved; the last message will not be restored after a restart.");
+    }
 }
 
 // Handle critical errors
@@ -179,7 +256,22 @@ void MainFrame::OnClose(wxCloseEvent& event)
     if (ioTimer)
     {
         ioTimer->Stop();
-        Unbind(wxEVT_TIMER, &MainFrame::OnIOTimer, this);
+        Unbind(wxEVT_TIMER, &MainFrame::OnIOTimer, this, ID_IO_TIMER);
+    }
+    if (statusTimer)
+    {
+        statusTimer->Stop();
+        Unbind(wxEVT_TIMER, &MainFrame::OnStatusTimer, this, ID_STATUS_TIMER);
+    }
+    if (cacheTimer)
+    {
+        // Don't lose a message still waiting for its save
+        if (cacheTimer->IsRunning())
+        {
+            cacheTimer->Stop();
+            banner->SaveState();
+        }
+        Unbind(wxEVT_TIMER, &MainFrame::OnCacheTimer, this, ID_CACHE_TIMER);
     }
 
     event.Skip();  // Allow the default close operation to proceed
@@ -194,4 +286,14 @@ MainFrame::~MainFrame()
         delete ioTimer;
         ioTimer = nullptr;
     }
+    if (statusTimer)
+    {
+        delete statusTimer;
+        statusTimer = nullptr;
+    }
+    if (cacheTimer)
+    {
+        delete cacheTimer;
+        cacheTimer = nullptr;
+    }
 }
\ No newline at end of file
@@ -13,6 +13,9 @@
 #include "wx/taskbar.h"
 #include <string>
 #include "ScrollingBanner.h"
+#include "MessageDecoder.h"
+#include "PortMap.h"
+#include "io.h"
 
 /**
  * @brief Main window class that handles the LED display interface and I/O operations
@@ -27,7 +30,7 @@ class MainFrame : public wxFrame
 {
 public:
     // Constructor and destructor
-    MainFrame();
+    explicit MainFrame(MessageDecoder::CodePage codePage = MessageDecoder::CodePage::UTF8);
     virtual ~MainFrame();
     
     // Event handlers
@@ -35,13 +38,6 @@ public:
 
 private:
 
-    // Constants for i/o communication
-    static const long STATUS_PORT = 20;        // Port for status communication
-    static const long SPEED_PORT = 10;         // Port for speed control
-    static const long DATA_PORT_START = 150;   // Starting port for text data
-    static const unsigned char EXIT_STATUS = 99;     // Status code for exit command
-    static const unsigned char DATA_TERMINATOR = 0xFF; // Marks end of data transmission
-
     // Forward declaration for I/O thread handling
     class IOThread;
 
@@ -51,6 +47,8 @@ private:
     ScrollingBanner* banner;     // Displays scrolling text
     wxStaticText* staticText;    // Shows port information
     wxTimer* ioTimer;            // Timer for I/O polling
+    wxTimer* statusTimer;        // One-shot timer for throttled status bar updates
+    wxTimer* cacheTimer;         // One-shot timer for throttled cache saves
 
 
     // Thread Synchronization
@@ -62,12 +60,18 @@ private:
     int m_speed;                // Current scroll speed
 
     IOThread* ioThread;         // Pointer to I/O thread
+    IOFilePorts ioPorts;        // Port backend for the PortMap accessors
+    MessageDecoder m_decoder;   // Decodes message bytes into display text
+    wxString m_statusText;      // Reused status bar text
+    bool m_cacheWarned;         // A failed cache save has been reported
 
     // Private Methods
     void InitializeUI();        // Sets up the user interface
     void InitializeIO();        // Initializes I/O communication
     void OnIOTimer(wxTimerEvent& event);  // Handles I/O timer events
-    void ReadData();           // Reads data from I/O ports
+    void OnStatusTimer(wxTimerEvent& event);  // Shows the latest message in the status bar
+    void OnCacheTimer(wxTimerEvent& event);   // Saves the latest message for a warm start
+    void ReadData(const PortMap::ControllerSnapshot& ports);  // Reads data from a port snapshot
     void HandleNewData(const std::string& text, int speed);  // Processes new data
     void OnCriticalError();    // Handles critical errors
 
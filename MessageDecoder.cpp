@@ -0,0 +1,187 @@
+// MessageDecoder.cpp
+// Implementation of the message decoder
+
+#include "MessageDecoder.h"
+
+namespace
+{
+    const uint32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+    // CP437 (DOS) characters 0x80-0xFF as Unicode code points
+    const uint16_t CP437_HIGH[128] = {
+        0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x00E0, 0x00E5, 0x00E7,
+        0x00EA, 0x00EB, 0x00E8, 0x00EF, 0x00EE, 0x00EC, 0x00C4, 0x00C5,
+        0x00C9, 0x00E6, 0x00C6, 0x00F4, 0x00F6, 0x00F2, 0x00FB, 0x00F9,
+        0x00FF, 0x00D6, 0x00DC, 0x00A2, 0x00A3, 0x00A5, 0x20A7, 0x0192,
+        0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x00AA, 0x00BA,
+        0x00BF, 0x2310, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB,
+        0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556,
+        0x2555, 0x2563, 0x2551, 0x2557, 0x255D, 0x255C, 0x255B, 0x2510,
+        0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x255E, 0x255F,
+        0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x2567,
+        0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256B,
+        0x256A, 0x2518, 0x250C, 0x2588, 0x2584, 0x258C, 0x2590, 0x2580,
+        0x03B1, 0x00DF, 0x0393, 0x03C0, 0x03A3, 0x03C3, 0x00B5, 0x03C4,
+        0x03A6, 0x0398, 0x03A9, 0x03B4, 0x221E, 0x03C6, 0x03B5, 0x2229,
+        0x2261, 0x00B1, 0x2265, 0x2264, 0x2320, 0x2321, 0x00F7, 0x2248,
+        0x00B0, 0x2219, 0x00B7, 0x221A, 0x207F, 0x00B2, 0x25A0, 0x00A0
+    };
+}
+
+// Constructor
+MessageDecoder::MessageDecoder(CodePage initialCodePage)
+    : codePage(initialCodePage),
+    codePoint(0),
+    minimum(0),
+    remaining(0)
+{
+}
+
+// Begin
+// Clears the text but not its storage
+void MessageDecoder::Begin()
+{
+    text.clear();
+    codePoint = 0;
+    minimum = 0;
+    remaining = 0;
+}
+
+// Feed
+// Decodes a chunk of bytes in one pass
+void MessageDecoder::Feed(const unsigned char* bytes, size_t count)
+{
+    // The common case is short messages; avoid growing in steps
+    text.reserve(text.length() + count);
+
+    switch (codePage)
+    {
+    case CodePage::UTF8:
+        for (size_t i = 0; i < count; i++)
+            FeedUTF8(bytes[i]);
+        break;
+
+    case CodePage::CP437:
+        for (size_t i = 0; i < count; i++)
+            Append(bytes[i] < 0x80 ? bytes[i] : CP437_HIGH[bytes[i] - 0x80]);
+        break;
+
+    case CodePage::Latin1:
+        for (size_t i = 0; i < count; i++)
+            Append(bytes[i]);
+        break;
+    }
+}
+
+// Finish
+// A sequence cut off by the end of the message is replaced, not dropped
+const wxString& MessageDecoder::Finish()
+{
+    if (remaining > 0)
+    {
+        Append(REPLACEMENT_CHARACTER);
+        remaining = 0;
+    }
+    return text;
+}
+
+// FeedUTF8
+// One step of the UTF-8 state machine
+void MessageDecoder::FeedUTF8(unsigned char byte)
+{
+    if (remaining > 0)
+    {
+        if ((byte & 0xC0) == 0x80)
+        {
+            codePoint = (codePoint << 6) | (byte & 0x3F);
+            if (--remaining == 0)
+            {
+                // Reject overlong forms, surrogates and values past U+10FFFF
+                bool valid = codePoint >= minimum && codePoint <= 0x10FFFF
+                    && (codePoint < 0xD800 || codePoint > 0xDFFF);
+                Append(valid ? codePoint : REPLACEMENT_CHARACTER);
+            }
+            return;
+        }
+
+        // Sequence interrupted: replace it and decode this byte afresh
+        Append(REPLACEMENT_CHARACTER);
+        remaining = 0;
+    }
+
+    if (byte < 0x80)
+    {
+        Append(byte);
+    }
+    else if ((byte & 0xE0) == 0xC0)
+    {
+        codePoint = byte & 0x1F;
+        minimum = 0x80;
+        remaining = 1;
+    }
+    else if ((byte & 0xF0) == 0xE0)
+    {
+        codePoint = byte & 0x0F;
+        minimum = 0x800;
+        remaining = 2;
+    }
+    else if ((byte & 0xF8) == 0xF0)
+    {
+        codePoint = byte & 0x07;
+        minimum = 0x10000;
+        remaining = 3;
+    }
+    else
+    {
+        // Stray continuation byte or invalid lead byte
+        Append(REPLACEMENT_CHARACTER);
+    }
+}
+
+// Append
+// Adds a code point, as a surrogate pair where wchar_t is 16 bits
+void MessageDecoder::Append(uint32_t value)
+{
+    if (sizeof(wchar_t) == 2 && value > 0xFFFF)
+    {
+        value -= 0x10000;
+        text += static_cast<wchar_t>(0xD800 + (value >> 10));
+        text += static_cast<wchar_t>(0xDC00 + (value & 0x3FF));
+    }
+    else
+    {
+        text += static_cast<wchar_t>(value);
+    }
+}
+
+// Accessor Methods
+const wxString& MessageDecoder::GetText() const
+{
+    return text;
+}
+
+void MessageDecoder::SetCodePage(CodePage newCodePage)
+{
+    codePage = newCodePage;
+}
+
+MessageDecoder::CodePage MessageDecoder::GetCodePage() const
+{
+    return codePage;
+}
+
+// ParseCodePage
+// Maps a command line name to a code page
+bool MessageDecoder::ParseCodePage(const wxString& name, CodePage& result)
+{
+    wxString lower = name.Lower();
+    if (lower == "utf8" || lower == "utf-8")
+        result = CodePage::UTF8;
+    else if (lower == "cp437" || lower == "dos")
+        result = CodePage::CP437;
+    else if (lower == "latin1" || lower == "iso-8859-1")
+        result = CodePage::Latin1;
+    else
+        return false;
+    return true;
+}
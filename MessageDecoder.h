@@ -0,0 +1,69 @@
+// MessageDecoder.h
+// Converts raw controller bytes into display text
+
+#pragma once
+
+#include <wx/string.h>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Single-pass, incremental decoder for messages read from the ports
+ *
+ * Bytes are decoded as they are fed, straight into a text buffer that is
+ * reused from one message to the next, so steady-state decoding does not
+ * allocate. UTF-8 sequences may be split across Feed() calls; malformed or
+ * truncated sequences become U+FFFD instead of discarding the message.
+ *
+ * The 8086 controller sends 8-bit characters, so the DOS code page (CP437)
+ * and Latin-1 are available besides UTF-8.
+ */
+class MessageDecoder
+{
+public:
+    enum class CodePage { UTF8, CP437, Latin1 };
+
+    explicit MessageDecoder(CodePage initialCodePage = CodePage::UTF8);
+
+    /**
+     * @brief Starts a new message, keeping the buffer's capacity
+     */
+    void Begin();
+
+    /**
+     * @brief Decodes the next chunk of the current message
+     * @param bytes Raw bytes from the ports
+     * @param count Number of bytes
+     */
+    void Feed(const unsigned char* bytes, size_t count);
+
+    /**
+     * @brief Completes the current message
+     * @return Decoded text, valid until the next Begin()
+     */
+    const wxString& Finish();
+
+    /**
+     * @brief Gets the last decoded text
+     */
+    const wxString& GetText() const;
+
+    void SetCodePage(CodePage newCodePage);
+    CodePage GetCodePage() const;
+
+    /**
+     * @brief Parses a code page name ("utf8", "cp437" or "latin1")
+     * @return true if the name was recognised
+     */
+    static bool ParseCodePage(const wxString& name, CodePage& result);
+
+private:
+    void Append(uint32_t codePoint);   // Appends one code point to the text
+    void FeedUTF8(unsigned char byte); // Advances the UTF-8 state machine
+
+    CodePage codePage;       // Encoding of the incoming bytes
+    wxString text;           // Reused output buffer
+    uint32_t codePoint;      // UTF-8 sequence being assembled
+    uint32_t minimum;        // Smallest code point allowed for its length
+    int remaining;           // Continuation bytes still expected
+};
@@ -0,0 +1,265 @@
+// PortMap.h
+// Compile-time description of the LED Display Board port protocol
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @brief Typed map of the ports shared with the emu8086 controller
+ *
+ * Every port the protocol uses is described once here as a Field (a byte or
+ * 16-bit word with a value range and byte order) or a Block (a run of byte
+ * ports). Accessors are templates over the field, so port addresses, widths
+ * and offsets are constants and bounds are checked at compile time.
+ *
+ * Accessors work with any port backend providing:
+ *   unsigned char ReadByte(long port);
+ *   void WriteByte(long port, unsigned char value);
+ * and optionally, for bulk transfers:
+ *   void ReadBlock(long port, unsigned char* buffer, long count);
+ *
+ * The controller program ("Device control assembly code.asm") uses the same
+ * addresses through its EQU constants; keep both in sync.
+ */
+namespace PortMap
+{
+    // Size of the emu8086 port space
+    constexpr long PORT_SPACE = 65536;
+
+    enum class ByteOrder { LittleEndian, BigEndian };
+
+    /**
+     * @brief A single byte or word port with a valid value range
+     */
+    template <long Port, int Width, unsigned Min, unsigned Max,
+              ByteOrder Order = ByteOrder::LittleEndian>
+    struct Field
+    {
+        static_assert(Width == 1 || Width == 2, "Fields are bytes or 16-bit words");
+        static_assert(Port >= 0 && Port + Width <= PORT_SPACE, "Field lies outside the port space");
+        static_assert(Min <= Max && Max < (1u << (8 * Width)), "Value range does not fit the field width");
+
+        using value_type = typename std::conditional<Width == 1, uint8_t, uint16_t>::type;
+
+        static constexpr long first() { return Port; }
+        static constexpr long width() { return Width; }
+        static constexpr ByteOrder order() { return Order; }
+        static constexpr value_type minimum() { return static_cast<value_type>(Min); }
+        static constexpr value_type maximum() { return static_cast<value_type>(Max); }
+
+        // Compared as unsigned so full-range fields do not trip -Wtype-limits
+        static constexpr bool InRange(value_type value)
+        {
+            return static_cast<unsigned>(value) - Min <= Max - Min;
+        }
+
+        // Converts raw port bytes (in port order) to a value
+        static constexpr value_type Decode(const unsigned char* bytes)
+        {
+            return Width == 1 ? static_cast<value_type>(bytes[0])
+                : Order == ByteOrder::LittleEndian
+                    ? static_cast<value_type>(bytes[0] | (bytes[1] << 8))
+                    : static_cast<value_type>((bytes[0] << 8) | bytes[1]);
+        }
+    };
+
+    /**
+     * @brief A contiguous run of byte ports
+     */
+    template <long Port, long Count>
+    struct Block
+    {
+        static_assert(Count > 0, "Blocks must contain at least one port");
+        static_assert(Port >= 0 && Port + Count <= PORT_SPACE, "Block lies outside the port space");
+
+        static constexpr long first() { return Port; }
+        static constexpr long width() { return Count; }
+        static constexpr long end() { return Port + Count; }   // One past the last port
+    };
+
+    //-------------------------------------------------------------------------
+    // Protocol description
+    //-------------------------------------------------------------------------
+    using Speed = Field<10, 1, 0, 20>;       // Scroll speed (0 = static)
+    using Status = Field<20, 1, 0, 255>;     // Handshake status, see below
+    using Text = Block<150, 102>;            // Ports 150-251: text and terminator
+
+    // Values of the Status field
+    constexpr uint8_t STATUS_DONE = 0;           // Controller finished writing
+    constexpr uint8_t STATUS_WRITING = 1;        // Controller is writing
+    constexpr uint8_t STATUS_ACKNOWLEDGED = 2;   // Device has read the message
+    constexpr uint8_t STATUS_EXIT = 99;          // Controller asks the device to close
+
+    // Marks the end of the text inside the Text block
+    constexpr unsigned char DATA_TERMINATOR = 0xFF;
+
+    //-------------------------------------------------------------------------
+    // Backend dispatch
+    //-------------------------------------------------------------------------
+    namespace detail
+    {
+        // Uses the backend's bulk read when it has one...
+        template <typename Backend>
+        inline auto ReadBytes(Backend& io, long port, unsigned char* buffer, long count, int)
+            -> decltype(io.ReadBlock(port, buffer, count), void())
+        {
+            io.ReadBlock(port, buffer, count);
+        }
+
+        // ...and falls back to one byte at a time otherwise
+        template <typename Backend>
+        inline void ReadBytes(Backend& io, long port, unsigned char* buffer, long count, long)
+        {
+            for (long i = 0; i < count; i++)
+                buffer[i] = io.ReadByte(port + i);
+        }
+
+        template <typename F, typename Backend>
+        inline typename F::value_type ReadField(Backend& io, std::integral_constant<int, 1>)
+        {
+            return static_cast<typename F::value_type>(io.ReadByte(F::first()));
+        }
+
+        template <typename F, typename Backend>
+        inline typename F::value_type ReadField(Backend& io, std::integral_constant<int, 2>)
+        {
+            const unsigned char bytes[2] = { io.ReadByte(F::first()), io.ReadByte(F::first() + 1) };
+            return F::Decode(bytes);
+        }
+
+        template <typename F, typename Backend>
+        inline void WriteField(Backend& io, typename F::value_type value, std::integral_constant<int, 1>)
+        {
+            io.WriteByte(F::first(), static_cast<unsigned char>(value));
+        }
+
+        template <typename F, typename Backend>
+        inline void WriteField(Backend& io, typename F::value_type value, std::integral_constant<int, 2>)
+        {
+            const unsigned char low = static_cast<unsigned char>(value & 0xFF);
+            const unsigned char high = static_cast<unsigned char>((value >> 8) & 0xFF);
+            const bool little = F::order() == ByteOrder::LittleEndian;
+            io.WriteByte(F::first(), little ? low : high);
+            io.WriteByte(F::first() + 1, little ? high : low);
+        }
+
+        // Smallest first port and largest end port of a set of fields
+        constexpr long MinOf(long value) { return value; }
+        template <typename... Rest>
+        constexpr long MinOf(long a, long b, Rest... rest) { return MinOf(a < b ? a : b, rest...); }
+
+        constexpr long MaxOf(long value) { return value; }
+        template <typename... Rest>
+        constexpr long MaxOf(long a, long b, Rest... rest) { return MaxOf(a > b ? a : b, rest...); }
+
+        template <typename... Fields>
+        struct Span
+        {
+            static constexpr long first() { return MinOf(Fields::first()...); }
+            static constexpr long end() { return MaxOf((Fields::first() + Fields::width())...); }
+            static constexpr long size() { return end() - first(); }
+        };
+
+        template <typename F, typename... Fields>
+        struct Contains : std::false_type {};
+
+        template <typename F, typename Head, typename... Tail>
+        struct Contains<F, Head, Tail...>
+            : std::integral_constant<bool, std::is_same<F, Head>::value || Contains<F, Tail...>::value> {};
+    }
+
+    //-------------------------------------------------------------------------
+    // Accessors
+    //-------------------------------------------------------------------------
+
+    /**
+     * @brief Reads a field from the backend
+     * @return Field value decoded in the field's byte order
+     */
+    template <typename F, typename Backend>
+    inline typename F::value_type Read(Backend& io)
+    {
+        return detail::ReadField<F>(io, std::integral_constant<int, F::width()>());
+    }
+
+    /**
+     * @brief Writes a field to the backend
+     * @param value Value to store, encoded in the field's byte order
+     * @throws std::out_of_range if the value is outside the field's range
+     */
+    template <typename F, typename Backend>
+    inline void Write(Backend& io, typename F::value_type value)
+    {
+        if (!F::InRange(value))
+        {
+            throw std::out_of_range("Value is outside the port field's range");
+        }
+        detail::WriteField<F>(io, value, std::integral_constant<int, F::width()>());
+    }
+
+    /**
+     * @brief Writes 'count' bytes to the start of a block
+     * @throws std::out_of_range if the bytes do not fit in the block
+     */
+    template <typename B, typename Backend>
+    inline void WriteBlock(Backend& io, const unsigned char* bytes, long count)
+    {
+        if (count < 0 || count > B::width())
+        {
+            throw std::out_of_range("Data does not fit in the port block");
+        }
+        for (long i = 0; i < count; i++)
+            io.WriteByte(B::first() + i, bytes[i]);
+    }
+
+    /**
+     * @brief Copy of the ports covering a set of fields, read in one transfer
+     *
+     * The layout (span and each field's offset) is fixed at compile time, so
+     * Get() is a load from the buffer at a constant offset.
+     */
+    template <typename... Fields>
+    class Snapshot
+    {
+    public:
+        using Layout = detail::Span<Fields...>;
+
+        /**
+         * @brief Reads the whole span from the backend
+         */
+        template <typename Backend>
+        void Load(Backend& io)
+        {
+            detail::ReadBytes(io, Layout::first(), bytes, Layout::size(), 0);
+        }
+
+        /**
+         * @brief Value of a field captured by the last Load()
+         */
+        template <typename F>
+        typename F::value_type Get() const
+        {
+            static_assert(detail::Contains<F, Fields...>::value, "Field is not part of this snapshot");
+            return F::Decode(bytes + (F::first() - Layout::first()));
+        }
+
+        /**
+         * @brief Raw bytes of a field or block captured by the last Load()
+         */
+        template <typename F>
+        const unsigned char* Data() const
+        {
+            static_assert(detail::Contains<F, Fields...>::value, "Field is not part of this snapshot");
+            return bytes + (F::first() - Layout::first());
+        }
+
+    private:
+        unsigned char bytes[Layout::size()];
+    };
+
+    // Everything the device reads on a poll: status, speed and text
+    using ControllerSnapshot = Snapshot<Speed, Status, Text>;
+}
@@ -2,11 +2,22 @@
 // Implementation of the LED display simulation panel
 
 #include "ScrollingBanner.h"
+#include "PortMap.h"
 #include <wx/dcbuffer.h>
 #include "resource2.h"
 #include <windows.h>
 #include <wx/stdpaths.h>
 #include <wx/file.h>
+#include <wx/rawbmp.h>
+
+namespace
+{
+    // LED colours: dark red panel, bright red segments
+    const unsigned char LED_BACKGROUND[3] = { 61, 14, 14 };
+    const unsigned char LED_FOREGROUND[3] = { 244, 14, 14 };
+
+    const int TEXT_OFFSET_Y = 5;   // Vertical position of the text in the panel
+}
 
 // Register event handlers
 wxBEGIN_EVENT_TABLE(ScrollingBanner, wxPanel)
@@ -16,17 +27,47 @@ wxBEGIN_EVENT_TABLE(ScrollingBanner, wxPanel)
 wxEND_EVENT_TABLE()
 
 // Constructor
-// Initializes the banner panel and loads custom font
+// Initializes the banner panel; the custom font is installed on first use
 ScrollingBanner::ScrollingBanner(wxWindow* parent)
     : wxPanel(parent, wxID_ANY),
+    timer(this),
+    cache(BannerCache::DefaultPath()),
     displayTextPosX(0),
     speedFactor(2),
-    timer(this)
+    textWidth(0),
+    fontInstalled(false)
 {
     // Enable double buffering to prevent flicker
     SetBackgroundStyle(wxBG_STYLE_PAINT);
 
-    // Load custom LED font from resources
+    // Set dark red background color
+    SetBackgroundColour(wxColour(LED_BACKGROUND[0], LED_BACKGROUND[1], LED_BACKGROUND[2]));
+
+    // Colours of the off-screen strip never change; set them once
+    stripDC.SetBackground(wxBrush(GetBackgroundColour()));
+    stripDC.SetTextForeground(wxColour(LED_FOREGROUND[0], LED_FOREGROUND[1], LED_FOREGROUND[2]));
+}
+
+
+// Destructor
+// Ensures timer is stopped when panel is destroyed
+ScrollingBanner::~ScrollingBanner()
+{
+    if (timer.IsRunning())
+    {
+        timer.Stop();
+    }
+}
+
+// InstallFont
+// Loads the custom LED font from resources and creates textFont, once per run.
+// Deferred until a message must be rendered so a warm start skips it.
+void ScrollingBanner::InstallFont()
+{
+    if (fontInstalled)
+        return;
+    fontInstalled = true;
+
     HINSTANCE hInstance = GetModuleHandle(NULL);
     HRSRC fontRes = FindResource(hInstance, MAKEINTRESOURCE(IDR_FONT2), RT_FONT);
     if (fontRes)
@@ -58,63 +99,164 @@ ScrollingBanner::ScrollingBanner(wxWindow* parent)
             }
         }
     }
-}
 
-
-// Destructor
-// Ensures timer is stopped when panel is destroyed
-ScrollingBanner::~ScrollingBanner()
-{
-    if (timer.IsRunning())
-    {
-        timer.Stop();
-    }
+    // Set up custom LED font
+    textFont = wxFont(55, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL,
+                     wxFONTWEIGHT_NORMAL, false, "Bold LED Board-7");
+    stripDC.SetFont(textFont);
 }
 
 // UpdateBanner
 // Updates the banner text and scroll speed
 void ScrollingBanner::UpdateBanner(const wxString& text, int speed)
 {
-    displayText = text;
-    
-    // Ensure that the speed is between 0 and 20
-    if (speed < 0) {
-        speedFactor = 0;
-    }
-    else if (speed > 20) {
-        speedFactor = 20;
-    }
-    else {
-        speedFactor = speed;
-    }
+    SetSpeed(speed);
+    InstallFont();
 
-    // Set up custom LED font
-    textFont = wxFont(55, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, 
-                     wxFONTWEIGHT_NORMAL, false, "Bold LED Board-7");
-
-    // Set dark red background color
-    SetBackgroundColour(wxColour(61, 14, 14));
+    // Render the text once; frames only blit the strip. The strip does not
+    // depend on the speed, so a repeated text keeps the current one.
+    if (!textStrip.IsOk() || text != displayText)
+    {
+        displayText = text;
+        RenderStrip();
+    }
 
     // Handle scrolling or static display
     if (speedFactor > 0)
     {
         // Start scrolling from right edge
         displayTextPosX = GetClientSize().GetWidth();
-        if (!timer.IsRunning())
-        {
-            timer.Start(10);  // Update every 10ms
-        }
     }
     else
     {
         // Center text for static display
-        if (timer.IsRunning())
+        displayTextPosX = (GetClientSize().GetWidth() - GetTextWidth()) / 2;
+    }
+    StartAnimation();
+    Refresh();
+}
+
+
+// CaptureMessage
+// Copies the text (as UTF-8), speed and position into savedState, whose
+// buffers are reused so this does not allocate once the largest message
+// so far has been saved
+void ScrollingBanner::CaptureMessage()
+{
+    const size_t utf8Length = wxConvUTF8.FromWChar(NULL, 0, displayText.wc_str(), displayText.length());
+    savedState.text.resize(utf8Length == wxCONV_FAILED ? 0 : utf8Length);
+    if (!savedState.text.empty())
+    {
+        wxConvUTF8.FromWChar(&savedState.text[0], utf8Length, displayText.wc_str(), displayText.length());
+    }
+    savedState.speed = speedFactor;
+    savedState.scrollPosX = displayTextPosX;
+}
+
+
+// SaveMessage
+// Stores the committed text and speed without the strip. This is a copy of
+// a few hundred bytes into the already mapped file, cheap enough to do for
+// every message; the cached strip is stale until the next SaveState().
+bool ScrollingBanner::SaveMessage()
+{
+    CaptureMessage();
+    savedState.stripWidth = 0;
+    savedState.stripHeight = 0;
+    return cache.Store(savedState);
+}
+
+
+// SaveState
+// Stores the committed message and its rendered strip as a coverage mask
+bool ScrollingBanner::SaveState()
+{
+    CaptureMessage();
+
+    // The strip only holds the two LED colours (plus anti-aliasing between
+    // them), so the red channel alone recovers the coverage. Only the columns
+    // covered by the text are stored. RenderStrip() creates the strip as a
+    // 24-bit bitmap, the only format wxNativePixelData reads on MSW.
+    wxNativePixelData pixels(textStrip);
+    if (!pixels)
+    {
+        return false;
+    }
+    savedState.stripWidth = wxMin(wxMax(textWidth, 1), pixels.GetWidth());
+    savedState.stripHeight = pixels.GetHeight();
+    savedState.coverage.resize(static_cast<size_t>(savedState.stripWidth) * savedState.stripHeight);
+
+    const int range = LED_FOREGROUND[0] - LED_BACKGROUND[0];
+    wxNativePixelData::Iterator row(pixels);
+    for (int y = 0; y < savedState.stripHeight; y++)
+    {
+        wxNativePixelData::Iterator pixel = row;
+        for (int x = 0; x < savedState.stripWidth; x++, ++pixel)
         {
-            timer.Stop();
+            int level = (pixel.Red() - LED_BACKGROUND[0]) * 255 / range;
+            savedState.coverage[y * savedState.stripWidth + x] =
+                static_cast<unsigned char>(wxMin(wxMax(level, 0), 255));
         }
-        displayTextPosX = (GetClientSize().GetWidth() - GetTextWidth()) / 2;
-        Refresh();
+        row.OffsetY(pixels, 1);
     }
+
+    return cache.Store(savedState);
+}
+
+
+// RestoreState
+// Rebuilds the strip from the cache (or renders the cached text again if its
+// strip was not saved) so the first frame shows the last message
+bool ScrollingBanner::RestoreState()
+{
+    BannerCacheState state;
+    if (!cache.Load(state))
+    {
+        return false;
+    }
+
+    displayText = wxString::FromUTF8(state.text.data(), state.text.size());
+    SetSpeed(state.speed);
+
+    if (state.stripWidth > 0 && state.stripHeight > 0)
+    {
+        // Expand the coverage mask back into LED colours
+        wxImage image(state.stripWidth, state.stripHeight, false);
+        unsigned char* rgb = image.GetData();
+        for (size_t i = 0; i < state.coverage.size(); i++)
+        {
+            int level = state.coverage[i];
+            for (int channel = 0; channel < 3; channel++)
+            {
+                int from = LED_BACKGROUND[channel];
+                int to = LED_FOREGROUND[channel];
+                rgb[i * 3 + channel] = static_cast<unsigned char>(from + (to - from) * level / 255);
+            }
+        }
+        textStrip = wxBitmap(image, 24);
+        textWidth = state.stripWidth;
+    }
+    else
+    {
+        // Saved by SaveMessage() before its strip was: render it now
+        InstallFont();
+        RenderStrip();
+    }
+
+    // Resume where the text was when the program stopped. The position is not
+    // checksummed, so keep it where at least part of the text is visible.
+    int panelWidth = GetClientSize().GetWidth();
+    if (speedFactor > 0)
+    {
+        displayTextPosX = wxMin(wxMax(state.scrollPosX, -textWidth), panelWidth);
+    }
+    else
+    {
+        displayTextPosX = (panelWidth - textWidth) / 2;
+    }
+    StartAnimation();
+    Refresh();
+    return true;
 }
 
 
@@ -124,17 +266,16 @@ void ScrollingBanner::OnPaint(wxPaintEvent& event)
 {
     // Set up double-buffered drawing
     wxAutoBufferedPaintDC dc(this);
-    
+
     // Clear background
     dc.SetBackground(GetBackgroundColour());
     dc.Clear();
 
-    // Set up text drawing
-    dc.SetFont(textFont);
-    dc.SetTextForeground(wxColour(244, 14, 14));  // Bright red text
-
-    // Draw the text at current position
-    dc.DrawText(displayText, displayTextPosX, 5);
+    // Draw the pre-rendered text at current position
+    if (textStrip.IsOk())
+    {
+        dc.DrawBitmap(textStrip, displayTextPosX, TEXT_OFFSET_Y);
+    }
 }
 
 
@@ -151,6 +292,9 @@ void ScrollingBanner::OnTimer(wxTimerEvent& event)
         displayTextPosX = GetClientSize().GetWidth();
     }
 
+    // Keep the cached position current for a warm start
+    cache.UpdateScrollPosition(displayTextPosX);
+
     // Request redraw
     Refresh();
 }
@@ -166,14 +310,67 @@ void ScrollingBanner::OnEraseBackground(wxEraseEvent& event)
 
 
 // GetTextWidth
-// Calculates the pixel width of the current display text
+// Returns the pixel width of the current display text, measured by RenderStrip
 int ScrollingBanner::GetTextWidth()
 {
-    // Create DC for text measurement
-    wxClientDC dc(this);
-    dc.SetFont(textFont);
-    wxSize textSize = dc.GetTextExtent(displayText);
-    return textSize.GetWidth();
+    return textWidth;
+}
+
+
+// SetSpeed
+// Ensures that the speed is within the range of the speed port
+void ScrollingBanner::SetSpeed(int speed)
+{
+    if (speed < PortMap::Speed::minimum()) {
+        speedFactor = PortMap::Speed::minimum();
+    }
+    else if (speed > PortMap::Speed::maximum()) {
+        speedFactor = PortMap::Speed::maximum();
+    }
+    else {
+        speedFactor = speed;
+    }
+}
+
+
+// StartAnimation
+// Runs the scroll timer for moving text and stops it for static text
+void ScrollingBanner::StartAnimation()
+{
+    if (speedFactor > 0)
+    {
+        if (!timer.IsRunning())
+        {
+            timer.Start(10);  // Update every 10ms
+        }
+    }
+    else if (timer.IsRunning())
+    {
+        timer.Stop();
+    }
+}
+
+
+// RenderStrip
+// Draws displayText once into an off-screen bitmap at least as wide as the text
+void ScrollingBanner::RenderStrip()
+{
+    wxSize textSize = stripDC.GetTextExtent(displayText);
+    textWidth = textSize.GetWidth();
+
+    // Reuse the bitmap unless the text no longer fits; only the first
+    // textWidth columns belong to the text, the rest stays background.
+    // The depth is fixed at 24 bits (not the screen's) so SaveState() can
+    // read the pixels directly.
+    int height = wxMax(textSize.GetHeight(), 1);
+    if (!textStrip.IsOk() || textStrip.GetWidth() < textWidth || textStrip.GetHeight() != height)
+    {
+        textStrip = wxBitmap(wxMax(textWidth, 1), height, 24);
+    }
+    stripDC.SelectObject(textStrip);
+    stripDC.Clear();
+    stripDC.DrawText(displayText, 0, 0);
+    stripDC.SelectObject(wxNullBitmap);
 }
 
 
@@ -186,4 +383,4 @@ int ScrollingBanner::GetSpeedFactor() const
 wxString ScrollingBanner::GetBannerText() const
 {
     return displayText;
-}
\ No newline at end of file
+}
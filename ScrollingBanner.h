@@ -6,6 +6,7 @@
 // Include required wxWidgets components
 #include <wx/wx.h>
 #include <wx/timer.h>
+#include "BannerCache.h"
 
 /**
  * @brief Panel class that simulates an LED display with scrolling text
@@ -15,6 +16,7 @@
  * - Adjustable scroll speed
  * - Custom LED-style font rendering
  * - Static text display option (speed = 0)
+ * - Warm start from the last committed message (see BannerCache)
  */
 class ScrollingBanner : public wxPanel
 {
@@ -33,6 +35,27 @@ public:
      */
     void UpdateBanner(const wxString& text, int speed);
 
+    /**
+     * @brief Persists the current text and speed to the cache, without the strip
+     *
+     * Cheap enough to call for every message. Until the next SaveState() a
+     * warm start renders the text again instead of using a cached strip.
+     * @return true if the cache was written
+     */
+    bool SaveMessage();
+
+    /**
+     * @brief Persists the current text, speed and rendered strip to the cache
+     * @return true if the cache was written
+     */
+    bool SaveState();
+
+    /**
+     * @brief Restores the last saved banner from the cache
+     * @return true if a valid cache was found and is now displayed
+     */
+    bool RestoreState();
+
     /**
      * @brief Gets the current scroll speed
      * @return Current speed factor (0-20)
@@ -52,8 +75,14 @@ private:
     wxTimer timer;           // Timer for animation control
     wxString displayText;    // Text currently being displayed
     wxFont textFont;         // Custom LED-style font
+    wxBitmap textStrip;      // Text pre-rendered once per message
+    wxMemoryDC stripDC;      // Reused DC for rendering into textStrip
+    BannerCache cache;       // Warm-start cache file
+    BannerCacheState savedState;  // Reused buffers for SaveMessage() and SaveState()
     int displayTextPosX;     // Current X position of text
     int speedFactor;         // Current scroll speed
+    int textWidth;           // Pixel width of the rendered text
+    bool fontInstalled;      // LED font has been installed from resources
 
     
     // Private Methods - Event Handlers
@@ -61,7 +90,12 @@ private:
     void OnPaint(wxPaintEvent& event);           // Handles paint events
     void OnTimer(wxTimerEvent& event);           // Updates text position
     void OnEraseBackground(wxEraseEvent& event); // Prevents flicker
-    int GetTextWidth();                          // Calculates text width
+    int GetTextWidth();                          // Returns the rendered text width
+    void InstallFont();                          // Installs and creates the LED font on first use
+    void SetSpeed(int speed);                    // Clamps and applies the scroll speed
+    void StartAnimation();                       // Starts or stops the scroll timer
+    void RenderStrip();                          // Renders displayText into textStrip
+    void CaptureMessage();                       // Copies text, speed and position into savedState
 
     wxDECLARE_EVENT_TABLE();    // Macro for wxWidgets event handling
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 // Implementation of hardware I/O operations for LED Display Board
 
 #include "io.h"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
@@ -32,6 +33,28 @@ unsigned char READ_IO_BYTE(long port) {
 }
 
 
+// READ_IO_BLOCK
+// Reads consecutive I/O ports with one open/seek/read instead of one per port
+void READ_IO_BLOCK(long port, unsigned char* buffer, long count) {
+    // Ports beyond the end of the file read as zero, like READ_IO_BYTE
+    std::fill(buffer, buffer + count, static_cast<unsigned char>(0));
+
+    // Open I/O file in binary read mode
+    std::fstream io_file(IO_FILE, std::ios::in | std::ios::binary);
+
+    // Check if file opened successfully
+    if (!io_file) {
+        throw std::runtime_error("Cannot read I/O file. Please ensure 'C:\\emu8086.io' file exists. "
+                               "Make sure that you are running the program with administrator privileges.");
+    }
+
+    // Seek to first port and read the whole range
+    io_file.seekg(port, std::ios::beg);
+    io_file.read(reinterpret_cast<char*>(buffer), count);
+    io_file.close();
+}
+
+
 // WRITE_IO_BYTE
 // Writes a single byte to the specified I/O port-
 void WRITE_IO_BYTE(long port, unsigned char value) {
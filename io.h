@@ -3,12 +3,7 @@
 
 #pragma once
 
-// Port Definitions\\ Unneccesary
-//const long STATUS_PORT = 0x00;
-//const long SPEED_PORT = 0x01;
-//const long DATA_PORT_START = 0x02;
-//const unsigned char DATA_TERMINATOR = '\0';
-//const unsigned char EXIT_STATUS = 0xFF;
+// Port addresses and their layout are described in PortMap.h
 
 /**
  * @brief Reads a single byte from specified I/O port
@@ -24,6 +19,14 @@ unsigned char READ_IO_BYTE(long port);
  */
 short int READ_IO_WORD(long port);
 
+/**
+ * @brief Reads consecutive I/O ports in a single file access
+ * @param port First port address to read from
+ * @param buffer Receives the port values
+ * @param count Number of ports to read
+ */
+void READ_IO_BLOCK(long port, unsigned char* buffer, long count);
+
 /**
  * @brief Writes a single byte to specified I/O port
  * @param port Port address to write to
@@ -37,3 +40,13 @@ void WRITE_IO_BYTE(long port, unsigned char value);
  * @param value Word value to write
  */
 void WRITE_IO_WORD(long port, short int value);
+
+/**
+ * @brief Port backend over the emulated I/O file, for the PortMap accessors
+ */
+struct IOFilePorts
+{
+    unsigned char ReadByte(long port) { return READ_IO_BYTE(port); }
+    void WriteByte(long port, unsigned char value) { WRITE_IO_BYTE(port, value); }
+    void ReadBlock(long port, unsigned char* buffer, long count) { READ_IO_BLOCK(port, buffer, count); }
+};
@@ -0,0 +1,545 @@
+// LoadGenerator.cpp
+// Synthetic controller load generator for the LED Display Board
+//
+// Plays the emu8086 controller's side of the STATUS_PORT handshake against
+// the port file and measures how many updates the device actually absorbs:
+//
+//   controller: status = 1, text -> ports 150.., 0xFF, speed -> port 10, status = 0
+//   device:     sees status 0, reads text and speed, writes status = 2
+//
+// Linux only (POSIX file I/O). Build with:
+//   g++ -std=c++17 -O2 -pthread tools/LoadGenerator.cpp -o led_loadgen
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../PortMap.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Port layout shared with the device
+using PortMap::Speed;
+using PortMap::Status;
+using PortMap::Text;
+
+static const long PORT_FILE_SIZE = 65536;      // Size of the emu8086 port file
+
+/**
+ * @brief How the synthetic controller behaves
+ *
+ * - Polite: waits for the device's acknowledgement before every new message
+ * - Eager:  writes at the requested rate without waiting, overwriting
+ *           messages the device has not picked up yet
+ * - Torn:   raises the "ready" status before the text is written, pausing
+ *           after each byte, so the device may consume a half-written message
+ */
+enum class WriterMode { Polite, Eager, Torn };
+
+/**
+ * @brief Command line options for a load run
+ */
+struct Options
+{
+    std::string portFile;        // Port file shared with the device
+    double rate = 10.0;          // Messages per second (0 = as fast as possible)
+    int size = 32;               // Text length in characters (1 to Text::width() - 1)
+    double duration = 10.0;      // Length of the run in seconds
+    int timeoutMs = 1000;        // Time to wait for an acknowledgement
+    int devicePollMs = 0;        // Poll interval of the built-in device (0 = off)
+    int byteDelayUs = 200;       // Pause after each payload byte in torn mode
+    WriterMode mode = WriterMode::Polite;
+    bool sendExit = false;       // Write EXIT_STATUS at the end of the run
+};
+
+/**
+ * @brief Counters collected during a load run
+ */
+struct Results
+{
+    long sent = 0;               // Messages published by the controller
+    long accepted = 0;           // Messages acknowledged by the device
+    long lost = 0;               // Messages never acknowledged within the timeout
+    long overwritten = 0;        // Messages replaced before the device read them
+    long torn = 0;               // Acknowledged before the text was complete
+    long possiblyTorn = 0;       // Acknowledged after a ready-before-write publish
+    long longestStall = 0;       // Longest run of consecutive lost messages
+    double elapsed = 0.0;        // Wall clock seconds
+    std::vector<double> latencies;  // Publish-to-acknowledge times in ms
+};
+
+/**
+ * @brief Byte-addressed view of the emu8086 port file
+ *
+ * Keeps a single descriptor open for the whole run; every access is a
+ * positioned read or write of one byte, the same granularity the device uses.
+ * Serves as the port backend for the PortMap accessors.
+ */
+class PortFile
+{
+public:
+    explicit PortFile(const std::string& path)
+    {
+        fd = open(path.c_str(), O_RDWR | O_CREAT, 0666);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Cannot open port file '" + path + "': " + std::strerror(errno));
+        }
+
+        // Make sure every port the protocol touches exists
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size < PORT_FILE_SIZE)
+        {
+            if (ftruncate(fd, PORT_FILE_SIZE) != 0)
+            {
+                close(fd);
+                throw std::runtime_error("Cannot resize port file '" + path + "'");
+            }
+        }
+    }
+
+    ~PortFile()
+    {
+        close(fd);
+    }
+
+    PortFile(const PortFile&) = delete;
+    PortFile& operator=(const PortFile&) = delete;
+
+    unsigned char ReadByte(long port) const
+    {
+        unsigned char value = 0;
+        if (pread(fd, &value, 1, port) != 1)
+        {
+            throw std::runtime_error("Port read failed");
+        }
+        return value;
+    }
+
+    void WriteByte(long port, unsigned char value) const
+    {
+        if (pwrite(fd, &value, 1, port) != 1)
+        {
+            throw std::runtime_error("Port write failed");
+        }
+    }
+
+private:
+    int fd;
+};
+
+/**
+ * @brief Port backend that pauses after every byte written
+ *
+ * Used by the torn writer so the payload takes long enough to write that a
+ * polling device can actually catch it half-written.
+ */
+class PacedPorts
+{
+public:
+    PacedPorts(const PortFile& ports, std::chrono::microseconds delay)
+        : ports(ports), delay(delay)
+    {
+    }
+
+    unsigned char ReadByte(long port) const
+    {
+        return ports.ReadByte(port);
+    }
+
+    void WriteByte(long port, unsigned char value) const
+    {
+        ports.WriteByte(port, value);
+        if (delay.count() > 0)
+        {
+            std::this_thread::sleep_for(delay);
+        }
+    }
+
+private:
+    const PortFile& ports;
+    std::chrono::microseconds delay;
+};
+
+// Default port file: the C:\emu8086.io the device opens when run under Wine
+static std::string DefaultPortFile()
+{
+    const char* home = std::getenv("HOME");
+    return home ? std::string(home) + "/.wine/drive_c/emu8086.io" : std::string("emu8086.io");
+}
+
+// Builds a recognisable message of exactly 'size' characters
+static std::string MakeMessage(long sequence, int size)
+{
+    char prefix[32];
+    std::snprintf(prefix, sizeof(prefix), "MSG %06ld ", sequence);
+    std::string text(prefix);
+    while (static_cast<int>(text.size()) < size)
+    {
+        text += static_cast<char>('A' + (text.size() % 26));
+    }
+    text.resize(size);
+    return text;
+}
+
+// Writes text, terminator and speed into the data ports
+template <typename Backend>
+static void WritePayload(Backend& ports, const std::string& text, unsigned char speed)
+{
+    std::string data = text;
+    data += static_cast<char>(PortMap::DATA_TERMINATOR);
+    PortMap::WriteBlock<Text>(ports, reinterpret_cast<const unsigned char*>(data.data()),
+        static_cast<long>(data.size()));
+    PortMap::Write<Speed>(ports, speed);
+}
+
+// Milliseconds between two time points
+static double ElapsedMs(Clock::time_point from, Clock::time_point to)
+{
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+/**
+ * @brief Minimal stand-in for MainFrame::OnIOTimer
+ *
+ * Polls the status port at a fixed interval and acknowledges each message,
+ * so the generator can be exercised without the Windows device running.
+ * Runs on its own thread; a port error stops it and is handed back through
+ * 'error' for main() to report.
+ */
+static void EmulateDevice(const PortFile& ports, int pollMs, const std::atomic<bool>& stop,
+    std::exception_ptr& error)
+{
+    try {
+        while (!stop)
+        {
+            // One bulk read per poll, like the device
+            PortMap::ControllerSnapshot snapshot;
+            snapshot.Load(ports);
+
+            unsigned char status = snapshot.Get<Status>();
+            if (status == PortMap::STATUS_EXIT)
+            {
+                return;
+            }
+            if (status == PortMap::STATUS_DONE)
+            {
+                PortMap::Write<Status>(ports, PortMap::STATUS_ACKNOWLEDGED);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(pollMs));
+        }
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+}
+
+/**
+ * @brief Runs the controller side of the protocol for the configured duration
+ */
+static Results RunLoad(const PortFile& ports, const Options& options)
+{
+    Results results;
+
+    const auto start = Clock::now();
+    const auto end = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(options.duration));
+    const auto interval = options.rate > 0.0
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / options.rate))
+        : Clock::duration::zero();
+    const auto timeout = std::chrono::milliseconds(options.timeoutMs);
+    const PacedPorts pacedPorts(ports, std::chrono::microseconds(options.byteDelayUs));
+
+    bool pending = false;            // A published message awaits acknowledgement
+    bool pendingTorn = false;        // It was announced before its text was written
+    Clock::time_point publishedAt;   // When the pending message was published
+    long consecutiveLost = 0;
+    auto nextSend = start;
+
+    // Settles the pending message as accepted or lost. A ready-before-write
+    // message may have been read half-written whenever its ack arrives, so it
+    // never counts as accepted or contributes a latency sample.
+    auto settle = [&](bool acked, Clock::time_point now)
+    {
+        if (acked && pendingTorn)
+        {
+            results.possiblyTorn++;
+            consecutiveLost = 0;
+        }
+        else if (acked)
+        {
+            results.accepted++;
+            results.latencies.push_back(ElapsedMs(publishedAt, now));
+            consecutiveLost = 0;
+        }
+        else
+        {
+            results.lost++;
+            consecutiveLost++;
+            results.longestStall = std::max(results.longestStall, consecutiveLost);
+        }
+        pending = false;
+    };
+
+    // Polls for the pending acknowledgement until 'deadline'; returns true once settled
+    auto waitForAck = [&](Clock::time_point deadline) -> bool
+    {
+        while (pending)
+        {
+            auto now = Clock::now();
+            if (PortMap::Read<Status>(ports) == PortMap::STATUS_ACKNOWLEDGED)
+            {
+                settle(true, now);
+                return true;
+            }
+            if (now - publishedAt >= timeout)
+            {
+                settle(false, now);
+                return true;
+            }
+            if (now >= deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    };
+
+    while (Clock::now() < end)
+    {
+        // Pace the run; eager writers only look for acknowledgements in between
+        waitForAck(options.mode == WriterMode::Eager ? nextSend : Clock::time_point::max());
+        std::this_thread::sleep_until(nextSend);
+        nextSend = std::max(nextSend + interval, Clock::now());
+
+        if (pending)
+        {
+            // Eager writer about to replace an unread message. Look once more
+            // so an ack that arrived since the last poll is not overwritten.
+            if (PortMap::Read<Status>(ports) == PortMap::STATUS_ACKNOWLEDGED)
+            {
+                settle(true, Clock::now());
+            }
+            else
+            {
+                results.overwritten++;
+                pending = false;
+            }
+        }
+
+        std::string text = MakeMessage(results.sent, options.size);
+        unsigned char speed = static_cast<unsigned char>(
+            Speed::minimum() + results.sent % (Speed::maximum() - Speed::minimum() + 1));
+
+        if (options.mode == WriterMode::Torn)
+        {
+            // Announce first, then write slowly enough for the device to
+            // catch the text half-written
+            PortMap::Write<Status>(ports, PortMap::STATUS_DONE);
+            publishedAt = Clock::now();
+            pending = true;
+            pendingTorn = true;
+            WritePayload(pacedPorts, text, speed);
+            if (PortMap::Read<Status>(ports) == PortMap::STATUS_ACKNOWLEDGED)
+            {
+                // Acknowledged before the text was complete: certainly torn
+                results.torn++;
+                consecutiveLost = 0;
+                pending = false;
+            }
+        }
+        else
+        {
+            PortMap::Write<Status>(ports, PortMap::STATUS_WRITING);
+            WritePayload(ports, text, speed);
+            PortMap::Write<Status>(ports, PortMap::STATUS_DONE);
+            publishedAt = Clock::now();
+            pending = true;
+            pendingTorn = false;
+        }
+        results.sent++;
+    }
+
+    // Give the last message its full timeout
+    waitForAck(Clock::time_point::max());
+
+    results.elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    return results;
+}
+
+// Returns the requested percentile of an already sorted sample
+static double Percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty())
+        return 0.0;
+    size_t index = static_cast<size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static const char* ModeName(WriterMode mode)
+{
+    switch (mode)
+    {
+    case WriterMode::Eager: return "eager";
+    case WriterMode::Torn:  return "torn";
+    default:                return "polite";
+    }
+}
+
+static void PrintReport(const Options& options, Results& results)
+{
+    std::sort(results.latencies.begin(), results.latencies.end());
+    double seconds = results.elapsed > 0.0 ? results.elapsed : 1.0;
+
+    std::printf("Port file:            %s\n", options.portFile.c_str());
+    std::printf("Writer mode:          %s\n", ModeName(options.mode));
+    std::printf("Target rate:          %.1f msg/s, %d chars\n", options.rate, options.size);
+    if (options.mode == WriterMode::Torn)
+    {
+        std::printf("Byte delay:           %d us\n", options.byteDelayUs);
+    }
+    std::printf("Elapsed:              %.2f s\n", results.elapsed);
+    std::printf("Messages sent:        %ld (%.2f msg/s)\n", results.sent, results.sent / seconds);
+    std::printf("Accepted:             %ld (%.2f msg/s)\n", results.accepted, results.accepted / seconds);
+    std::printf("Lost (timed out):     %ld\n", results.lost);
+    std::printf("Overwritten:          %ld\n", results.overwritten);
+    std::printf("Torn:                 %ld (acknowledged before the text was complete)\n", results.torn);
+    std::printf("Acked, possibly torn: %ld (announced before writing; not counted as accepted)\n",
+        results.possiblyTorn);
+    std::printf("Longest stall:        %ld consecutive lost\n", results.longestStall);
+    std::printf("Handshake latency ms: p50 %.1f  p90 %.1f  p99 %.1f  max %.1f\n",
+        Percentile(results.latencies, 50), Percentile(results.latencies, 90),
+        Percentile(results.latencies, 99),
+        results.latencies.empty() ? 0.0 : results.latencies.back());
+}
+
+static void PrintUsage(const char* program)
+{
+    std::printf(
+        "Usage: %s [options]\n"
+        "  --port-file PATH     Port file shared with the device (default: %s)\n"
+        "  --rate N             Messages per second, 0 = as fast as possible (default: 10)\n"
+        "  --size N             Characters per message, 1-%ld (default: 32)\n"
+        "  --duration S         Run length in seconds (default: 10)\n"
+        "  --timeout MS         Acknowledgement timeout (default: 1000)\n"
+        "  --mode MODE          polite | eager | torn (default: polite)\n"
+        "  --byte-delay US      Pause after each payload byte in torn mode (default: 200)\n"
+        "  --emulate-device MS  Run a built-in device polling every MS milliseconds\n"
+        "  --exit               Send the exit status to the device when done\n",
+        program, DefaultPortFile().c_str(), Text::width() - 1);
+}
+
+// Parses the command line; returns false if the program should stop
+static bool ParseOptions(int argc, char** argv, Options& options)
+{
+    options.portFile = DefaultPortFile();
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string
+        {
+            if (i + 1 >= argc)
+                throw std::invalid_argument("Missing value for " + arg);
+            return argv[++i];
+        };
+
+        if (arg == "--port-file")           options.portFile = value();
+        else if (arg == "--rate")           options.rate = std::stod(value());
+        else if (arg == "--size")           options.size = std::stoi(value());
+        else if (arg == "--duration")       options.duration = std::stod(value());
+        else if (arg == "--timeout")        options.timeoutMs = std::stoi(value());
+        else if (arg == "--emulate-device") options.devicePollMs = std::stoi(value());
+        else if (arg == "--byte-delay")     options.byteDelayUs = std::stoi(value());
+        else if (arg == "--exit")           options.sendExit = true;
+        else if (arg == "--mode")
+        {
+            std::string mode = value();
+            if (mode == "polite")     options.mode = WriterMode::Polite;
+            else if (mode == "eager") options.mode = WriterMode::Eager;
+            else if (mode == "torn")  options.mode = WriterMode::Torn;
+            else throw std::invalid_argument("Unknown mode '" + mode + "'");
+        }
+        else if (arg == "--help" || arg == "-h")
+        {
+            PrintUsage(argv[0]);
+            return false;
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown option '" + arg + "'");
+        }
+    }
+
+    // The text ports also hold the terminator
+    if (options.size < 1 || options.size > Text::width() - 1)
+        throw std::invalid_argument("--size must be between 1 and " + std::to_string(Text::width() - 1));
+    if (options.rate < 0.0)
+        throw std::invalid_argument("--rate must not be negative");
+    if (options.duration <= 0.0)
+        throw std::invalid_argument("--duration must be positive");
+    if (options.timeoutMs <= 0)
+        throw std::invalid_argument("--timeout must be positive");
+    if (options.devicePollMs < 0)
+        throw std::invalid_argument("--emulate-device must not be negative");
+    if (options.byteDelayUs < 0)
+        throw std::invalid_argument("--byte-delay must not be negative");
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    try {
+        Options options;
+        if (!ParseOptions(argc, argv, options))
+            return 0;
+
+        PortFile ports(options.portFile);
+
+        // Optional in-process device
+        std::atomic<bool> stopDevice(false);
+        std::exception_ptr deviceError;
+        std::thread device;
+        if (options.devicePollMs > 0)
+        {
+            device = std::thread(EmulateDevice, std::cref(ports), options.devicePollMs,
+                std::cref(stopDevice), std::ref(deviceError));
+        }
+
+        Results results = RunLoad(ports, options);
+
+        if (options.sendExit)
+        {
+            PortMap::Write<Status>(ports, PortMap::STATUS_EXIT);
+        }
+        if (device.joinable())
+        {
+            stopDevice = true;
+            device.join();
+        }
+        if (deviceError)
+        {
+            std::rethrow_exception(deviceError);
+        }
+
+        PrintReport(options, results);
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "Error: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}